@@ -12,11 +12,21 @@
 #include "hardware/adc.h"    // Biblioteca para leitura de valores analógicos (ADC)
 #include "hardware/clocks.h" // Biblioteca para gerenciamento de clocks
 #include "hardware/pwm.h"    // Biblioteca para controle de saída PWM
+#include "hardware/uart.h"   // Biblioteca para envio do espelho do display pela UART
 
 // Bibliotecas para controle do display OLED
 #include "include/ssd1306.h" // Controlador do display OLED SSD1306
 #include "include/font.h"    // Biblioteca de fontes para renderização de texto no display
 
+// Saída do LED com PWM de 16 bits, correção gama e transições via DMA
+#include "include/led_pwm.h"
+
+// Pipeline do sensor de luz: sobreamostragem, decimação, suavização e zona morta
+#include "include/canal_luz.h"
+
+// Espelhamento remoto do display: envia pela UART apenas as mudanças do framebuffer
+#include "include/espelho.h"
+
 // ===============================
 // Definição de Pinos e Parâmetros
 // ===============================
@@ -45,6 +55,20 @@
 // Definição do limite de ruído para ativação do alerta
 #define LIMITE_SOM 2600  // Valor do ADC acima do qual o alerta sonoro será ativado
 
+// Parâmetros do canal de luz (modo luminosidade)
+#define LUZ_SOBREAMOSTRAGEM 64       // Amostras por leitura (16 a 256): 64 amostras = 15 bits efetivos
+#define LUZ_SUAVIZACAO 2             // Constante do filtro exponencial (alfa = 1/4)
+#define LUZ_ZONA_MORTA 4             // Variação mínima, em contagens do ADC de 12 bits, para atualizar
+#define LUZ_TAXA_ATUALIZACAO_HZ 20   // Leituras decimadas por segundo
+
+// Modo espelho: envia as alterações do display pela UART para o visualizador
+// (tools/visualizador_espelho.c). Usa a UART1, separada do stdio (UART0). Use 0 para desativar.
+#define ESPELHO_UART 1
+#define ESPELHO_UART_PORTA uart1        // UART dedicada ao espelho
+#define ESPELHO_UART_TX 8               // Pino TX da UART1 (o espelho só transmite)
+#define ESPELHO_UART_BAUD 115200        // Taxa de transmissão do espelho
+#define ESPELHO_INTERVALO_CHAVE_MS 1000 // Envia um quadro completo a cada 1 s, mesmo com a tela parada
+
 // Tempo de duração das notas musicais emitidas pelo buzzer (em milissegundos)
 #define TEMPO_NOTA 100  // Define que cada nota sonora dura 100ms
 
@@ -58,6 +82,13 @@ ssd1306_t display;
 // Variável global para armazenar a opção atualmente selecionada no menu
 int opcao_menu = 0;  // 0 = Modo de Luminosidade, 1 = Modo de Teste de Ruído
 
+#if ESPELHO_UART
+// Estado do codificador do espelho e buffer do quadro serial
+espelho_t espelho;
+uint8_t buffer_espelho[ESPELHO_TAMANHO_MAX];
+absolute_time_t proximo_quadro_chave; // Instante do próximo quadro completo
+#endif
+
 // ===============================
 // Funções de Configuração
 // ===============================
@@ -71,13 +102,52 @@ void configurar_i2c() {
     gpio_pull_up(I2C_SCL); // Habilita resistor de pull-up no pino SCL
 }
 
+// Configura a UART dedicada ao espelho do display
+void configurar_espelho() {
+#if ESPELHO_UART
+    uart_init(ESPELHO_UART_PORTA, ESPELHO_UART_BAUD); // Inicializa a UART1 na taxa do visualizador
+    gpio_set_function(ESPELHO_UART_TX, GPIO_FUNC_UART); // Define o pino TX como função UART
+    espelho_init(&espelho); // O primeiro quadro espelhado será completo
+    proximo_quadro_chave = make_timeout_time_ms(ESPELHO_INTERVALO_CHAVE_MS);
+#endif
+}
+
+// Envia pela UART as alterações do framebuffer desde o último quadro espelhado
+void enviar_espelho() {
+#if ESPELHO_UART
+    // O primeiro byte do ram_buffer é o byte de controle I2C, não faz parte da imagem
+    size_t tamanho = espelho_codificar(&espelho, display.ram_buffer + 1, buffer_espelho, sizeof(buffer_espelho));
+    if (tamanho > 0) {
+        uart_write_blocking(ESPELHO_UART_PORTA, buffer_espelho, tamanho);
+    }
+#endif
+}
+
+// Envia um quadro completo a cada ESPELHO_INTERVALO_CHAVE_MS, mesmo sem mudanças na tela,
+// para que um visualizador recém-conectado (ou que perdeu dados) volte a reconstruir a imagem
+void manter_espelho() {
+#if ESPELHO_UART
+    if (time_reached(proximo_quadro_chave)) {
+        espelho_forcar_quadro_chave(&espelho);
+        enviar_espelho();
+        proximo_quadro_chave = make_timeout_time_ms(ESPELHO_INTERVALO_CHAVE_MS);
+    }
+#endif
+}
+
+// Envia o framebuffer ao display e, no modo espelho, as alterações pela UART
+void atualizar_display() {
+    ssd1306_send_data(&display);
+    enviar_espelho();
+}
+
 // Inicializa e configura o display OLED SSD1306 via I2C
 void configurar_display() {
     ssd1306_init(&display, 128, 64, false, ENDERECO_DISPLAY, I2C_PORT); // Configura o display para resolução 128x64
     ssd1306_config(&display); // Aplica configurações padrão ao display
     sleep_ms(200); // Pequeno atraso para garantir a inicialização correta do display
     ssd1306_fill(&display, false); // Limpa a tela do display
-    ssd1306_send_data(&display); // Atualiza o display com a tela limpa
+    atualizar_display(); // Atualiza o display com a tela limpa
 }
 
 // Configura o ADC para leitura dos sensores analógicos (potenciômetro e microfone)
@@ -109,6 +179,11 @@ void configurar_buzzer() {
     pwm_set_enabled(slice2, true); // Habilita PWM no buzzer 2
 }
 
+// Configura o LED como saída PWM de 16 bits com transições suaves por DMA
+void configurar_led() {
+    led_pwm_init(LED_PWM); // Define o pino, o wrap de 16 bits e reserva o canal DMA
+}
+
 // ===============================
 // Funções de Entrada
 // ===============================
@@ -152,7 +227,7 @@ void exibir_menu() {
 /*         ssd1306_draw_string_inverted(&display, "2 RUIDO", 10, pos_y_opcao2);
  */    }
 
-    ssd1306_send_data(&display); // Atualiza o display com as novas informações
+    atualizar_display(); // Atualiza o display com as novas informações
 }
 
 // ===============================
@@ -160,11 +235,11 @@ void exibir_menu() {
 // ===============================
 
 // Exibe no display OLED o nível de luminosidade medido e o brilho ajustado do LED
-void exibir_luminosidade(int brilho, int valor_adc) {
+void exibir_luminosidade(int brilho, uint32_t valor_luz, uint32_t valor_maximo, int bits) {
     char buffer[50]; // Buffer para armazenar strings formatadas
 
-    // Converte a leitura do ADC (0-4095) para um valor percentual (0-100%)
-    int luminosidade = (valor_adc * 100) / 4095;
+    // Converte a leitura filtrada (0 a valor_maximo) para um valor percentual (0-100%)
+    int luminosidade = (valor_luz * 100) / valor_maximo;
 
     // Limpa a tela do display antes de exibir novos dados
     ssd1306_fill(&display, false);
@@ -177,8 +252,12 @@ void exibir_luminosidade(int brilho, int valor_adc) {
     sprintf(buffer, "BRILHO %d", brilho);
     ssd1306_draw_string(&display, buffer, 10, 25);
 
+    // Exibe a resolução efetiva obtida com a sobreamostragem
+    sprintf(buffer, "RES %d BITS", bits);
+    ssd1306_draw_string(&display, buffer, 10, 40);
+
     // Atualiza o display com as novas informações
-    ssd1306_send_data(&display);
+    atualizar_display();
 }
 
 // ===============================
@@ -267,7 +346,7 @@ void exibir_indicador_som(uint16_t mic_value) {
     }
 
     // Atualiza o display OLED com as novas informações
-    ssd1306_send_data(&display);
+    atualizar_display();
 }
 
 // ===============================
@@ -280,10 +359,12 @@ int main() {
 
     // Configura os periféricos do Raspberry Pi Pico
     configurar_i2c();
+    configurar_espelho();
     configurar_display();
     configurar_botoes();
     configurar_adc();
     configurar_buzzer();
+    configurar_led();
 
     // Exibe o menu inicial no display
     exibir_menu();
@@ -317,18 +398,34 @@ int main() {
         if (verificar_entrada()) {  
             if (opcao_menu == 0) {  // MODO: LUMINOSIDADE
                 bool tarefa_luminancia_ativa = true;
+                canal_luz_t canal_luz;
+                canal_luz_init(&canal_luz, LUZ_SOBREAMOSTRAGEM, LUZ_SUAVIZACAO, LUZ_ZONA_MORTA);
                 while (tarefa_luminancia_ativa) {
+                    // Rajada de amostras: o canal devolve verdadeiro apenas se o valor filtrado
+                    // atravessar a zona morta, evitando redesenhar e reenviar a tela sem necessidade
                     adc_select_input(0);
-                    int leitura_adc = adc_read();
-                    int brilho = 255 - (leitura_adc * 255 / 4095);
-                    pwm_set_gpio_level(LED_PWM, brilho);
-                    exibir_luminosidade(brilho, leitura_adc);
+                    bool luz_mudou = false;
+                    // Usa o fator ajustado pelo canal (potência de 2 entre 16 e 256)
+                    for (int i = 0; i < canal_luz.sobreamostragem; i++) {
+                        luz_mudou |= canal_luz_processar(&canal_luz, adc_read());
+                    }
+
+                    if (luz_mudou) {
+                        uint32_t valor_luz = canal_luz_valor(&canal_luz);
+                        uint32_t valor_maximo = canal_luz_maximo(&canal_luz);
+                        // Brilho perceptual em 16 bits; a correção gama e o fade ficam no módulo do LED
+                        uint16_t brilho = LED_PWM_BRILHO_MAX - (uint16_t)(((uint64_t)valor_luz * LED_PWM_BRILHO_MAX) / valor_maximo);
+                        led_pwm_definir_brilho(brilho);
+                        exibir_luminosidade(brilho >> 8, valor_luz, valor_maximo, canal_luz_bits(&canal_luz));
+                    }
     
                     if (verificar_saida()) {
                         tarefa_luminancia_ativa = false;
+                        led_pwm_apagar(); // Desliga o LED ao sair do modo luminosidade
                         exibir_menu();
                     }
-                    sleep_ms(100);
+                    manter_espelho();
+                    sleep_ms(1000 / LUZ_TAXA_ATUALIZACAO_HZ);
                 }
             } else if (opcao_menu == 1) {  // MODO: TESTE DE RUÍDO
                 bool tarefa_som_ativa = true;
@@ -343,11 +440,13 @@ int main() {
                         gpio_put(BUZZER_2, 0);
                         exibir_menu();
                     }
+                    manter_espelho();
                     sleep_ms(100);
                 }
             }
         }
     
+        manter_espelho(); // Mantém o espelho sincronizado mesmo com o menu parado
         sleep_ms(100);
     }
     
@@ -0,0 +1,79 @@
+#include "include/canal_luz.h"
+
+// Configura o canal de luz.
+//  sobreamostragem: amostras por saída (16 a 256, arredondado para potência de 2);
+//                   cada fator 4 acrescenta 1 bit efetivo à resolução de 12 bits do ADC.
+//  suavizacao:      constante do filtro exponencial; 0 desativa a suavização.
+//  zona_morta:      variação mínima, em contagens do ADC de 12 bits, para publicar um novo valor.
+void canal_luz_init(canal_luz_t *canal, uint16_t sobreamostragem, uint8_t suavizacao, uint16_t zona_morta) {
+  if (sobreamostragem < CANAL_LUZ_SOBREAMOSTRAGEM_MIN)
+    sobreamostragem = CANAL_LUZ_SOBREAMOSTRAGEM_MIN;
+  if (sobreamostragem > CANAL_LUZ_SOBREAMOSTRAGEM_MAX)
+    sobreamostragem = CANAL_LUZ_SOBREAMOSTRAGEM_MAX;
+
+  uint8_t log2_n = 0;
+  while ((2u << log2_n) <= sobreamostragem)
+    log2_n++;
+
+  canal->sobreamostragem = 1u << log2_n;
+  canal->bits_extras = log2_n / 2;
+  canal->deslocamento = log2_n - canal->bits_extras;
+  canal->suavizacao = (suavizacao > 8) ? 8 : suavizacao;
+  canal->zona_morta = (uint32_t)zona_morta << canal->bits_extras;
+
+  canal->soma = 0;
+  canal->contagem = 0;
+  canal->filtrado = 0;
+  canal->publicado = 0;
+  canal->valido = false;
+}
+
+// Recebe uma amostra bruta do ADC. Retorna verdadeiro quando o valor publicado muda,
+// ou seja, quando a saída filtrada atravessa a zona morta (ou na primeira saída).
+bool canal_luz_processar(canal_luz_t *canal, uint16_t amostra) {
+  // Decimador boxcar (CIC de um estágio): soma N amostras e entrega uma saída
+  canal->soma += amostra & ((1u << CANAL_LUZ_BITS_ADC) - 1);
+  if (++canal->contagem < canal->sobreamostragem)
+    return false;
+
+  uint32_t decimado = canal->soma >> canal->deslocamento;
+  canal->soma = 0;
+  canal->contagem = 0;
+
+  // Filtro exponencial em ponto fixo; a primeira saída inicializa o estado
+  uint32_t entrada = decimado << 8;
+  if (!canal->valido) {
+    canal->filtrado = entrada;
+  } else if (entrada >= canal->filtrado) {
+    canal->filtrado += (entrada - canal->filtrado) >> canal->suavizacao;
+  } else {
+    canal->filtrado -= (canal->filtrado - entrada) >> canal->suavizacao;
+  }
+  uint32_t valor = (canal->filtrado + 0x80) >> 8;
+
+  // Zona morta: só publica quando a variação supera o limite configurado
+  if (canal->valido) {
+    uint32_t variacao = (valor > canal->publicado) ? (valor - canal->publicado) : (canal->publicado - valor);
+    if (variacao <= canal->zona_morta)
+      return false;
+  }
+
+  canal->publicado = valor;
+  canal->valido = true;
+  return true;
+}
+
+// Último valor publicado, na resolução de saída (12 + bits extras)
+uint32_t canal_luz_valor(const canal_luz_t *canal) {
+  return canal->publicado;
+}
+
+// Maior valor possível na resolução de saída
+uint32_t canal_luz_maximo(const canal_luz_t *canal) {
+  return ((1u << CANAL_LUZ_BITS_ADC) - 1) << canal->bits_extras;
+}
+
+// Resolução efetiva de saída, em bits
+uint8_t canal_luz_bits(const canal_luz_t *canal) {
+  return CANAL_LUZ_BITS_ADC + canal->bits_extras;
+}
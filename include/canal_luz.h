@@ -0,0 +1,31 @@
+#include <stdint.h>
+#include <stdbool.h>
+
+// Limites da sobreamostragem (amostras do ADC somadas por saída decimada)
+#define CANAL_LUZ_SOBREAMOSTRAGEM_MIN 16
+#define CANAL_LUZ_SOBREAMOSTRAGEM_MAX 256
+
+// Resolução nativa do ADC do RP2040
+#define CANAL_LUZ_BITS_ADC 12
+
+typedef struct {
+  // Configuração
+  uint16_t sobreamostragem;  // Amostras por saída decimada (potência de 2)
+  uint8_t bits_extras;       // Bits efetivos ganhos com a sobreamostragem
+  uint8_t deslocamento;      // Deslocamento aplicado à soma do decimador
+  uint8_t suavizacao;        // Constante do filtro exponencial (alfa = 1 / 2^suavizacao)
+  uint32_t zona_morta;       // Variação mínima, na resolução de saída, para publicar um valor
+
+  // Estado
+  uint32_t soma;             // Acumulador do decimador boxcar
+  uint16_t contagem;         // Amostras acumuladas na janela atual
+  uint32_t filtrado;         // Saída do filtro exponencial (8 bits fracionários)
+  uint32_t publicado;        // Último valor entregue ao display e ao LED
+  bool valido;               // Indica se já houve um valor publicado
+} canal_luz_t;
+
+void canal_luz_init(canal_luz_t *canal, uint16_t sobreamostragem, uint8_t suavizacao, uint16_t zona_morta);
+bool canal_luz_processar(canal_luz_t *canal, uint16_t amostra);
+uint32_t canal_luz_valor(const canal_luz_t *canal);
+uint32_t canal_luz_maximo(const canal_luz_t *canal);
+uint8_t canal_luz_bits(const canal_luz_t *canal);
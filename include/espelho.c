@@ -0,0 +1,201 @@
+#include <string.h>
+#include "include/espelho.h"
+
+// Compacta 'n' bytes em PackBits: controle 0-127 = literal de controle+1 bytes,
+// 128-255 = repetição de controle-126 cópias (3 a 129) do byte seguinte.
+// Retorna o número de bytes escritos (no máximo n + n/128 + 1).
+static size_t compactar(const uint8_t *dados, size_t n, uint8_t *saida) {
+  size_t pos = 0;
+  size_t i = 0;
+
+  while (i < n) {
+    size_t repeticao = 1;
+    while (i + repeticao < n && repeticao < 129 && dados[i + repeticao] == dados[i])
+      repeticao++;
+
+    if (repeticao >= 3) {
+      saida[pos++] = (uint8_t)(repeticao + 126);
+      saida[pos++] = dados[i];
+      i += repeticao;
+      continue;
+    }
+
+    // Literal até o início da próxima repetição de 3 ou mais bytes
+    size_t inicio = i;
+    while (i < n && i - inicio < 128) {
+      if (i + 2 < n && dados[i] == dados[i + 1] && dados[i] == dados[i + 2])
+        break;
+      i++;
+    }
+    saida[pos++] = (uint8_t)(i - inicio - 1);
+    memcpy(&saida[pos], &dados[inicio], i - inicio);
+    pos += i - inicio;
+  }
+
+  return pos;
+}
+
+// XOR de flags, sequência, tamanho e carga (tudo após o sincronismo), para que
+// um erro no cabeçalho também seja detectado
+static uint8_t verificar(const uint8_t *quadro, size_t tamanho) {
+  uint8_t verificacao = 0;
+  for (size_t i = 2; i < tamanho; ++i)
+    verificacao ^= quadro[i];
+  return verificacao;
+}
+
+void espelho_init(espelho_t *espelho) {
+  memset(espelho->anterior, 0, sizeof(espelho->anterior));
+  espelho->sequencia = 0;
+  espelho->quadro_chave = true;
+}
+
+// O próximo quadro será enviado completo, permitindo que um receptor
+// que perdeu dados (ou acabou de conectar) volte a reconstruir a tela
+void espelho_forcar_quadro_chave(espelho_t *espelho) {
+  espelho->quadro_chave = true;
+}
+
+// Compara 'quadro' com a última cópia enviada, página a página, e escreve em 'saida'
+// apenas os trechos alterados. Retorna o tamanho do quadro serial, ou 0 se não houver
+// mudanças (ou se 'capacidade' for insuficiente; nesse caso o estado não é alterado).
+size_t espelho_codificar(espelho_t *espelho, const uint8_t *quadro, uint8_t *saida, size_t capacidade) {
+  if (espelho->quadro_chave)
+    memset(espelho->anterior, 0, sizeof(espelho->anterior));
+
+  uint8_t diferenca[ESPELHO_LARGURA];
+  size_t pos = ESPELHO_CABECALHO;
+
+  for (uint8_t pagina = 0; pagina < ESPELHO_PAGINAS; ++pagina) {
+    uint16_t coluna = 0;
+    while (coluna < ESPELHO_LARGURA) {
+      // Procura a próxima coluna alterada nesta página
+      while (coluna < ESPELHO_LARGURA &&
+             quadro[coluna * ESPELHO_PAGINAS + pagina] == espelho->anterior[coluna * ESPELHO_PAGINAS + pagina])
+        coluna++;
+      if (coluna == ESPELHO_LARGURA)
+        break;
+
+      // Estende o trecho enquanto as lacunas inalteradas forem curtas
+      uint16_t inicio = coluna;
+      uint16_t fim = coluna + 1;
+      for (uint16_t c = fim; c < ESPELHO_LARGURA && c - fim <= ESPELHO_LACUNA_MAX; ++c) {
+        if (quadro[c * ESPELHO_PAGINAS + pagina] != espelho->anterior[c * ESPELHO_PAGINAS + pagina])
+          fim = c + 1;
+      }
+
+      size_t quantidade = fim - inicio;
+      if (pos + 3 + quantidade + quantidade / 128 + 1 + 1 > capacidade)
+        return 0;
+
+      for (size_t i = 0; i < quantidade; ++i) {
+        size_t indice = (inicio + i) * ESPELHO_PAGINAS + pagina;
+        diferenca[i] = quadro[indice] ^ espelho->anterior[indice];
+      }
+
+      saida[pos++] = pagina;
+      saida[pos++] = (uint8_t)inicio;
+      saida[pos++] = (uint8_t)quantidade;
+      pos += compactar(diferenca, quantidade, &saida[pos]);
+      coluna = fim;
+    }
+  }
+
+  size_t carga = pos - ESPELHO_CABECALHO;
+  if (carga == 0 && !espelho->quadro_chave)
+    return 0;
+
+  saida[0] = ESPELHO_SINCRONISMO_0;
+  saida[1] = ESPELHO_SINCRONISMO_1;
+  saida[2] = espelho->quadro_chave ? ESPELHO_FLAG_CHAVE : 0;
+  saida[3] = espelho->sequencia;
+  saida[4] = (uint8_t)(carga & 0xFF);
+  saida[5] = (uint8_t)(carga >> 8);
+  saida[pos] = verificar(saida, pos);
+  pos++;
+
+  memcpy(espelho->anterior, quadro, ESPELHO_BYTES_QUADRO);
+  espelho->sequencia++;
+  espelho->quadro_chave = false;
+  return pos;
+}
+
+void espelho_receptor_init(espelho_receptor_t *receptor) {
+  memset(receptor->imagem, 0, sizeof(receptor->imagem));
+  receptor->sequencia = 0;
+  receptor->sincronizado = false;
+}
+
+// Tamanho total do quadro serial a partir dos ESPELHO_CABECALHO primeiros bytes,
+// ou 0 se o cabeçalho não começar com o sincronismo
+size_t espelho_tamanho_total(const uint8_t *cabecalho) {
+  if (cabecalho[0] != ESPELHO_SINCRONISMO_0 || cabecalho[1] != ESPELHO_SINCRONISMO_1)
+    return 0;
+  size_t carga = cabecalho[4] | ((size_t)cabecalho[5] << 8);
+  return ESPELHO_CABECALHO + carga + 1;
+}
+
+// Aplica um quadro serial completo à imagem do receptor. Retorna falso se o quadro
+// estiver corrompido ou se algum quadro anterior foi perdido; nesse caso a imagem
+// só volta a ser atualizada no próximo quadro chave.
+bool espelho_decodificar(espelho_receptor_t *receptor, const uint8_t *dados, size_t tamanho) {
+  if (tamanho < ESPELHO_CABECALHO + 1 || espelho_tamanho_total(dados) != tamanho)
+    return false;
+
+  const uint8_t *carga = &dados[ESPELHO_CABECALHO];
+  size_t tamanho_carga = tamanho - ESPELHO_CABECALHO - 1;
+
+  if (verificar(dados, tamanho - 1) != dados[tamanho - 1])
+    return false;
+
+  if (dados[2] & ESPELHO_FLAG_CHAVE) {
+    memset(receptor->imagem, 0, sizeof(receptor->imagem));
+    receptor->sincronizado = true;
+  } else if (dados[3] != receptor->sequencia) {
+    receptor->sincronizado = false;
+  }
+  receptor->sequencia = dados[3] + 1;
+  if (!receptor->sincronizado)
+    return false;
+
+  size_t pos = 0;
+  while (pos < tamanho_carga) {
+    if (pos + 3 > tamanho_carga)
+      return false;
+    uint8_t pagina = carga[pos++];
+    uint16_t coluna = carga[pos++];
+    uint16_t restantes = carga[pos++];
+    if (pagina >= ESPELHO_PAGINAS || coluna + restantes > ESPELHO_LARGURA)
+      return false;
+
+    // Expande o PackBits aplicando o XOR diretamente sobre a imagem
+    while (restantes > 0) {
+      if (pos + 2 > tamanho_carga)
+        return false;
+      uint8_t controle = carga[pos++];
+      if (controle < 128) {
+        uint16_t n = controle + 1;
+        if (n > restantes || pos + n > tamanho_carga)
+          return false;
+        for (uint16_t i = 0; i < n; ++i)
+          receptor->imagem[(coluna++) * ESPELHO_PAGINAS + pagina] ^= carga[pos++];
+        restantes -= n;
+      } else {
+        uint16_t n = controle - 126;
+        if (n > restantes)
+          return false;
+        uint8_t valor = carga[pos++];
+        for (uint16_t i = 0; i < n; ++i)
+          receptor->imagem[(coluna++) * ESPELHO_PAGINAS + pagina] ^= valor;
+        restantes -= n;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Estado do pixel (x, y) na imagem reconstruída
+bool espelho_pixel(const espelho_receptor_t *receptor, uint8_t x, uint8_t y) {
+  return (receptor->imagem[x * ESPELHO_PAGINAS + (y >> 3)] >> (y & 0x07)) & 1;
+}
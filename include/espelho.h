@@ -0,0 +1,50 @@
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Dimensões do framebuffer espelhado (SSD1306 128x64, endereçamento vertical:
+// o byte da coluna x e página p fica em quadro[x * ESPELHO_PAGINAS + p])
+#define ESPELHO_LARGURA 128
+#define ESPELHO_PAGINAS 8
+#define ESPELHO_BYTES_QUADRO (ESPELHO_LARGURA * ESPELHO_PAGINAS)
+
+// Formato de um quadro na serial:
+//   [0xA5][0x5A][flags][sequência][tamanho LSB][tamanho MSB] carga [verificação]
+// A verificação é o XOR de todos os bytes após o sincronismo (cabeçalho e carga).
+// A carga é uma lista de trechos [página][coluna][quantidade] seguidos dos bytes
+// (novo XOR anterior) do trecho, compactados em PackBits.
+#define ESPELHO_SINCRONISMO_0 0xA5
+#define ESPELHO_SINCRONISMO_1 0x5A
+#define ESPELHO_CABECALHO 6
+#define ESPELHO_FLAG_CHAVE 0x01     // Quadro completo: o receptor parte de uma tela apagada
+
+// Colunas inalteradas toleradas dentro de um trecho antes de abrir um novo
+// (um novo trecho custa 3 bytes de cabeçalho)
+#define ESPELHO_LACUNA_MAX 3
+
+// Pior caso de um quadro codificado, para dimensionar o buffer de saída
+#define ESPELHO_TAMANHO_MAX (ESPELHO_CABECALHO + 1 + \
+    ESPELHO_PAGINAS * (ESPELHO_LARGURA + 4 * (ESPELHO_LARGURA / (ESPELHO_LACUNA_MAX + 2) + 1)))
+
+typedef struct {
+  uint8_t anterior[ESPELHO_BYTES_QUADRO]; // Cópia do último quadro enviado
+  uint8_t sequencia;                      // Número do próximo quadro
+  bool quadro_chave;                      // Próximo quadro deve ser completo
+} espelho_t;
+
+typedef struct {
+  uint8_t imagem[ESPELHO_BYTES_QUADRO];   // Framebuffer reconstruído
+  uint8_t sequencia;                      // Sequência esperada no próximo quadro
+  bool sincronizado;                      // Já recebeu um quadro chave sem perdas desde então
+} espelho_receptor_t;
+
+// Transmissor
+void espelho_init(espelho_t *espelho);
+void espelho_forcar_quadro_chave(espelho_t *espelho);
+size_t espelho_codificar(espelho_t *espelho, const uint8_t *quadro, uint8_t *saida, size_t capacidade);
+
+// Receptor
+void espelho_receptor_init(espelho_receptor_t *receptor);
+size_t espelho_tamanho_total(const uint8_t *cabecalho);
+bool espelho_decodificar(espelho_receptor_t *receptor, const uint8_t *dados, size_t tamanho);
+bool espelho_pixel(const espelho_receptor_t *receptor, uint8_t x, uint8_t y);
@@ -0,0 +1,134 @@
+#include "include/led_pwm.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+
+// Tabela de correção gama (2,2) com 257 pontos: entrada = brilho perceptual >> 8,
+// saída = nível do PWM em 16 bits. O ponto extra permite interpolar o último intervalo.
+static const uint16_t tabela_gama[257] = {
+      0,     0,     2,     4,     7,    11,    17,    24,
+     32,    41,    52,    64,    78,    93,   110,   128,
+    147,   168,   191,   215,   240,   267,   296,   327,
+    359,   392,   428,   465,   504,   544,   586,   630,
+    676,   723,   772,   823,   875,   930,   986,  1044,
+   1104,  1165,  1229,  1294,  1361,  1430,  1501,  1574,
+   1648,  1725,  1803,  1884,  1966,  2050,  2136,  2224,
+   2314,  2406,  2500,  2595,  2693,  2793,  2895,  2998,
+   3104,  3212,  3322,  3433,  3547,  3663,  3781,  3900,
+   4022,  4146,  4272,  4400,  4530,  4663,  4797,  4933,
+   5072,  5212,  5355,  5499,  5646,  5795,  5946,  6099,
+   6255,  6412,  6572,  6733,  6897,  7063,  7231,  7402,
+   7574,  7749,  7926,  8105,  8286,  8469,  8655,  8843,
+   9033,  9225,  9419,  9616,  9815, 10016, 10219, 10425,
+  10632, 10842, 11054, 11269, 11486, 11705, 11926, 12149,
+  12375, 12603, 12833, 13066, 13301, 13538, 13777, 14019,
+  14263, 14509, 14758, 15009, 15262, 15517, 15775, 16035,
+  16298, 16563, 16830, 17099, 17371, 17645, 17922, 18201,
+  18482, 18765, 19051, 19339, 19630, 19923, 20218, 20516,
+  20816, 21119, 21424, 21731, 22040, 22352, 22667, 22984,
+  23303, 23624, 23949, 24275, 24604, 24935, 25269, 25605,
+  25943, 26284, 26628, 26973, 27322, 27672, 28026, 28381,
+  28739, 29100, 29462, 29828, 30196, 30566, 30939, 31314,
+  31692, 32072, 32454, 32840, 33227, 33617, 34010, 34405,
+  34802, 35202, 35605, 36010, 36417, 36827, 37240, 37655,
+  38072, 38493, 38915, 39340, 39768, 40198, 40631, 41066,
+  41503, 41944, 42387, 42832, 43280, 43730, 44183, 44639,
+  45097, 45557, 46020, 46486, 46954, 47425, 47899, 48374,
+  48853, 49334, 49818, 50304, 50793, 51284, 51778, 52275,
+  52774, 53276, 53780, 54287, 54796, 55308, 55823, 56341,
+  56860, 57383, 57908, 58436, 58966, 59499, 60035, 60573,
+  61114, 61657, 62203, 62752, 63303, 63857, 64414, 64973,
+  65535,
+};
+
+static uint slice_led;           // Slice PWM do pino do LED
+static uint canal_led;           // Canal (A ou B) do pino dentro do slice
+static int canal_dma = -1;       // Canal DMA que alimenta o registrador de comparação
+static uint32_t rampa[LED_PWM_PASSOS_RAMPA]; // Valores escritos no registrador CC a cada wrap
+
+static uint16_t brilho_inicio;   // Brilho perceptual no início da rampa atual
+static uint16_t brilho_alvo;     // Brilho perceptual ao fim da rampa atual
+static uint32_t passos_rampa;    // Quantidade de passos da rampa atual
+
+// Converte um brilho perceptual (0-65535) para o nível do PWM, interpolando a tabela gama
+uint16_t led_pwm_gama(uint16_t brilho) {
+    uint32_t indice = brilho >> 8;
+    uint32_t fracao = brilho & 0xFF;
+    uint32_t a = tabela_gama[indice];
+    uint32_t b = tabela_gama[indice + 1];
+    return (uint16_t)(a + (((b - a) * fracao) >> 8));
+}
+
+// Brilho perceptual após 'feitos' passos da rampa atual
+static uint16_t brilho_na_rampa(uint32_t feitos) {
+    if (feitos >= passos_rampa) return brilho_alvo;
+    int32_t delta = (int32_t)brilho_alvo - (int32_t)brilho_inicio;
+    return (uint16_t)(brilho_inicio + delta * (int32_t)feitos / (int32_t)passos_rampa);
+}
+
+// Configura o pino como PWM de 16 bits e reserva um canal DMA cadenciado pelo wrap do slice
+void led_pwm_init(uint gpio) {
+    gpio_set_function(gpio, GPIO_FUNC_PWM);
+    slice_led = pwm_gpio_to_slice_num(gpio);
+    canal_led = pwm_gpio_to_channel(gpio);
+
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_wrap(&config, LED_PWM_WRAP);
+    pwm_init(slice_led, &config, false);
+    pwm_set_chan_level(slice_led, canal_led, 0);
+    pwm_set_enabled(slice_led, true);
+
+    // Cada pedido DREQ (um por wrap) transfere uma palavra da rampa para o registrador CC
+    canal_dma = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pwm_get_dreq(slice_led));
+    dma_channel_configure(canal_dma, &c, &pwm_hw->slice[slice_led].cc, rampa, 0, false);
+
+    brilho_inicio = 0;
+    brilho_alvo = 0;
+    passos_rampa = 0;
+}
+
+// Inicia uma transição suave do brilho atual até o novo alvo (0 a LED_PWM_BRILHO_MAX).
+// A rampa é escrita pelo DMA no registrador de comparação, sem intervenção da CPU.
+void led_pwm_definir_brilho(uint16_t brilho) {
+    if (canal_dma < 0 || brilho == brilho_alvo) return;
+
+    // Descobre em que ponto da rampa anterior o LED está antes de interrompê-la
+    uint16_t atual = brilho_alvo;
+    if (dma_channel_is_busy(canal_dma)) {
+        uint32_t restantes = dma_channel_hw_addr(canal_dma)->transfer_count;
+        atual = brilho_na_rampa(passos_rampa - restantes);
+        dma_channel_abort(canal_dma);
+    }
+
+    // Rampas curtas para variações pequenas: a velocidade do fade é constante
+    uint32_t distancia = (brilho > atual) ? (brilho - atual) : (atual - brilho);
+    brilho_inicio = atual;
+    brilho_alvo = brilho;
+    passos_rampa = 1 + (distancia * (LED_PWM_PASSOS_RAMPA - 1)) / LED_PWM_BRILHO_MAX;
+
+    // Preserva o nível do outro canal do slice, pois o registrador CC guarda A e B juntos
+    uint32_t cc = pwm_hw->slice[slice_led].cc;
+    uint32_t deslocamento = (canal_led == PWM_CHAN_B) ? PWM_CH0_CC_B_LSB : PWM_CH0_CC_A_LSB;
+    uint32_t outro_canal = cc & ~(0xFFFFu << deslocamento);
+
+    for (uint32_t i = 0; i < passos_rampa; i++) {
+        uint32_t nivel = led_pwm_gama(brilho_na_rampa(i + 1));
+        rampa[i] = outro_canal | (nivel << deslocamento);
+    }
+
+    dma_channel_transfer_from_buffer_now(canal_dma, rampa, passos_rampa);
+}
+
+// Desliga o LED imediatamente, cancelando qualquer rampa em andamento
+void led_pwm_apagar(void) {
+    if (canal_dma < 0) return;
+    dma_channel_abort(canal_dma);
+    pwm_set_chan_level(slice_led, canal_led, 0);
+    brilho_inicio = 0;
+    brilho_alvo = 0;
+    passos_rampa = 0;
+}
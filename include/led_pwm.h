@@ -0,0 +1,15 @@
+#include "pico/stdlib.h"
+
+// Resolução do PWM do LED: wrap de 16 bits (~1,9 kHz com clk_sys de 125 MHz)
+#define LED_PWM_WRAP 0xFFFF
+
+// Brilho perceptual máximo aceito por led_pwm_definir_brilho (escala linear de 16 bits)
+#define LED_PWM_BRILHO_MAX 0xFFFF
+
+// Número máximo de passos de uma rampa (um passo por ciclo do PWM, ~0,5 ms cada)
+#define LED_PWM_PASSOS_RAMPA 256
+
+void led_pwm_init(uint gpio);
+uint16_t led_pwm_gama(uint16_t brilho);
+void led_pwm_definir_brilho(uint16_t brilho);
+void led_pwm_apagar(void);
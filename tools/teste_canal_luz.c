@@ -0,0 +1,104 @@
+// Teste do canal de luz (executa no computador, não no Pico)
+//
+// Compilar e executar a partir da raiz do projeto:
+//   gcc -O2 -I. tools/teste_canal_luz.c include/canal_luz.c -o teste_canal_luz && ./teste_canal_luz
+
+#include <stdio.h>
+
+#include "include/canal_luz.h"
+
+static int falhas = 0;
+
+#define VERIFICAR(condicao, ...) do { \
+    if (!(condicao)) { \
+        printf("FALHA (linha %d): ", __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        falhas++; \
+    } \
+} while (0)
+
+// Envia 'janelas' saídas decimadas com a mesma amostra; retorna quantas publicaram
+static int alimentar(canal_luz_t *canal, uint16_t amostra, int janelas) {
+    int publicacoes = 0;
+    for (int i = 0; i < janelas * canal->sobreamostragem; ++i)
+        publicacoes += canal_luz_processar(canal, amostra);
+    return publicacoes;
+}
+
+// 16, 64 e 256 amostras resultam em 14, 15 e 16 bits, com fundo de escala correspondente
+static void testar_resolucao(void) {
+    const uint16_t amostras[] = {16, 64, 256};
+    const uint8_t bits[] = {14, 15, 16};
+    const uint32_t fundo_escala[] = {16380, 32760, 65520};
+
+    for (int i = 0; i < 3; ++i) {
+        canal_luz_t canal;
+        canal_luz_init(&canal, amostras[i], 2, 4);
+        alimentar(&canal, 4095, 1);
+        VERIFICAR(canal_luz_bits(&canal) == bits[i], "%u amostras: %u bits", amostras[i], canal_luz_bits(&canal));
+        VERIFICAR(canal_luz_maximo(&canal) == fundo_escala[i], "%u amostras: maximo %u", amostras[i], canal_luz_maximo(&canal));
+        VERIFICAR(canal_luz_valor(&canal) == fundo_escala[i], "%u amostras: valor %u", amostras[i], canal_luz_valor(&canal));
+    }
+}
+
+// Fatores fora da faixa são limitados e os demais arredondados para a potência de 2 inferior
+static void testar_ajuste_sobreamostragem(void) {
+    const uint16_t pedidos[] = {0, 8, 17, 100, 255, 1000};
+    const uint16_t esperados[] = {16, 16, 16, 64, 128, 256};
+
+    for (int i = 0; i < 6; ++i) {
+        canal_luz_t canal;
+        canal_luz_init(&canal, pedidos[i], 2, 4);
+        VERIFICAR(canal.sobreamostragem == esperados[i], "pedido %u: %u amostras", pedidos[i], canal.sobreamostragem);
+    }
+}
+
+// Uma saída decimada a cada 'sobreamostragem' amostras: a primeira publica exatamente na última amostra da janela
+static void testar_taxa_de_saida(void) {
+    canal_luz_t canal;
+    canal_luz_init(&canal, 64, 2, 4);
+    for (int i = 0; i < 63; ++i)
+        VERIFICAR(!canal_luz_processar(&canal, 2000), "publicou antes do fim da janela (amostra %d)", i);
+    VERIFICAR(canal_luz_processar(&canal, 2000), "não publicou ao fim da primeira janela");
+}
+
+// Um degrau maior que a zona morta publica uma única vez (sem suavização);
+// com 64 amostras a saída tem 3 bits extras, ou seja, vale a amostra << 3
+static void testar_degrau(void) {
+    canal_luz_t canal;
+    canal_luz_init(&canal, 64, 0, 4);
+    VERIFICAR(alimentar(&canal, 2000, 10) == 1, "valor inicial deveria publicar uma vez");
+
+    int publicacoes = alimentar(&canal, 2100, 50);
+    VERIFICAR(publicacoes == 1, "degrau publicou %d vezes", publicacoes);
+    VERIFICAR(canal_luz_valor(&canal) == (2100u << 3), "valor após degrau %u", canal_luz_valor(&canal));
+}
+
+// Variações dentro da zona morta nunca publicam, com ou sem suavização
+static void testar_zona_morta(void) {
+    for (uint8_t suavizacao = 0; suavizacao <= 2; suavizacao += 2) {
+        canal_luz_t canal;
+        canal_luz_init(&canal, 64, suavizacao, 4);
+        alimentar(&canal, 2000, 10);
+
+        int publicacoes = alimentar(&canal, 2003, 50) + alimentar(&canal, 1997, 50);
+        VERIFICAR(publicacoes == 0, "suavizacao %u: zona morta publicou %d vezes", suavizacao, publicacoes);
+        VERIFICAR(canal_luz_valor(&canal) == (2000u << 3), "suavizacao %u: valor %u", suavizacao, canal_luz_valor(&canal));
+    }
+}
+
+int main(void) {
+    testar_resolucao();
+    testar_ajuste_sobreamostragem();
+    testar_taxa_de_saida();
+    testar_degrau();
+    testar_zona_morta();
+
+    if (falhas > 0) {
+        printf("%d verificações falharam\n", falhas);
+        return 1;
+    }
+    printf("canal_luz: todas as verificações passaram\n");
+    return 0;
+}
@@ -0,0 +1,170 @@
+// Visualizador do espelho do display (executa no computador, não no Pico)
+//
+// Compilar a partir da raiz do projeto:
+//   gcc -O2 -I. tools/visualizador_espelho.c include/espelho.c -o visualizador_espelho
+//
+// Uso:
+//   ./visualizador_espelho /dev/ttyUSB0   Lê os quadros da UART e desenha a tela no terminal
+//   ./visualizador_espelho                Lê os quadros da entrada padrão (ex.: captura salva)
+//   ./visualizador_espelho --bench [N]    Mede o custo do codificador com N quadros sintéticos
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "include/espelho.h"
+
+// ===============================
+// Exibição no terminal
+// ===============================
+
+// Desenha a imagem usando meio-bloco: cada linha do terminal mostra duas linhas de pixels
+static void desenhar(const espelho_receptor_t *receptor) {
+    printf("\033[H");
+    for (int y = 0; y < ESPELHO_PAGINAS * 8; y += 2) {
+        for (int x = 0; x < ESPELHO_LARGURA; ++x) {
+            bool cima = espelho_pixel(receptor, x, y);
+            bool baixo = espelho_pixel(receptor, x, y + 1);
+            fputs(cima ? (baixo ? "█" : "▀") : (baixo ? "▄" : " "), stdout);
+        }
+        putchar('\n');
+    }
+    fflush(stdout);
+}
+
+// Configura a porta serial em modo bruto a 115200 bauds (mesma taxa do stdio do Pico)
+static int abrir_serial(const char *caminho) {
+    int fd = open(caminho, O_RDONLY | O_NOCTTY);
+    if (fd < 0) {
+        perror(caminho);
+        return -1;
+    }
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, B115200);
+        cfsetospeed(&tio, B115200);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+static bool ler_byte(int fd, uint8_t *byte) {
+    return read(fd, byte, 1) == 1;
+}
+
+static int visualizar(int fd) {
+    espelho_receptor_t receptor;
+    espelho_receptor_init(&receptor);
+    uint8_t quadro[ESPELHO_TAMANHO_MAX];
+
+    printf("\033[2J");
+    while (1) {
+        // Procura o sincronismo, descartando qualquer outro texto da serial
+        uint8_t byte;
+        if (!ler_byte(fd, &byte)) return 0;
+        if (byte != ESPELHO_SINCRONISMO_0) continue;
+        quadro[0] = byte;
+        if (!ler_byte(fd, &quadro[1])) return 0;
+        if (quadro[1] != ESPELHO_SINCRONISMO_1) continue;
+
+        for (int i = 2; i < ESPELHO_CABECALHO; ++i)
+            if (!ler_byte(fd, &quadro[i])) return 0;
+
+        size_t total = espelho_tamanho_total(quadro);
+        if (total > sizeof(quadro)) continue;
+        for (size_t i = ESPELHO_CABECALHO; i < total; ++i)
+            if (!ler_byte(fd, &quadro[i])) return 0;
+
+        if (espelho_decodificar(&receptor, quadro, total))
+            desenhar(&receptor);
+    }
+}
+
+// ===============================
+// Benchmark do codificador
+// ===============================
+
+static double agora_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Altera o quadro de acordo com o cenário: 0 = nada muda, 1 = um campo de texto
+// (3 caracteres de 8 colunas numa página), 2 = tela inteira redesenhada
+static void gerar_quadro(uint8_t *quadro, int cenario, int indice) {
+    if (cenario == 1) {
+        int pagina = 3;
+        for (int x = 90; x < 90 + 24; ++x)
+            quadro[x * ESPELHO_PAGINAS + pagina] = (uint8_t)rand();
+    } else if (cenario == 2) {
+        for (int i = 0; i < ESPELHO_BYTES_QUADRO; ++i)
+            quadro[i] = (uint8_t)(rand() & ((indice & 1) ? 0x81 : 0xFF));
+    }
+}
+
+static int benchmark(int quadros) {
+    static const char *nomes[] = {"sem mudanca", "campo de texto", "tela cheia"};
+    uint8_t quadro[ESPELHO_BYTES_QUADRO];
+    uint8_t saida[ESPELHO_TAMANHO_MAX];
+    espelho_t espelho;
+    espelho_receptor_t receptor;
+
+    printf("%-16s %12s %14s %10s\n", "cenario", "us/quadro", "bytes/quadro", "vs 1 KB");
+    for (int cenario = 0; cenario < 3; ++cenario) {
+        srand(1234);
+        memset(quadro, 0, sizeof(quadro));
+        espelho_init(&espelho);
+        espelho_receptor_init(&receptor);
+
+        // O quadro chave inicial fica fora da medição
+        size_t tamanho = espelho_codificar(&espelho, quadro, saida, sizeof(saida));
+        espelho_decodificar(&receptor, saida, tamanho);
+
+        double tempo = 0;
+        size_t bytes = 0;
+        for (int i = 0; i < quadros; ++i) {
+            gerar_quadro(quadro, cenario, i);
+            double inicio = agora_us();
+            tamanho = espelho_codificar(&espelho, quadro, saida, sizeof(saida));
+            tempo += agora_us() - inicio;
+            bytes += tamanho;
+
+            // Confere a reconstrução a cada quadro
+            if (tamanho > 0 && !espelho_decodificar(&receptor, saida, tamanho)) {
+                fprintf(stderr, "%s: quadro %d rejeitado pelo receptor\n", nomes[cenario], i);
+                return 1;
+            }
+            if (memcmp(receptor.imagem, quadro, ESPELHO_BYTES_QUADRO) != 0) {
+                fprintf(stderr, "%s: imagem divergente no quadro %d\n", nomes[cenario], i);
+                return 1;
+            }
+        }
+
+        double media_bytes = (double)bytes / quadros;
+        printf("%-16s %12.3f %14.1f %9.1f%%\n", nomes[cenario], tempo / quadros,
+               media_bytes, 100.0 * media_bytes / ESPELHO_BYTES_QUADRO);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 2 && strcmp(argv[1], "--bench") == 0) {
+        int quadros = (argc >= 3) ? atoi(argv[2]) : 10000;
+        return benchmark(quadros > 0 ? quadros : 10000);
+    }
+
+    int fd = STDIN_FILENO;
+    if (argc >= 2) {
+        fd = abrir_serial(argv[1]);
+        if (fd < 0) return 1;
+    }
+    return visualizar(fd);
+}